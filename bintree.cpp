@@ -11,6 +11,7 @@
 //       appropriate operators for comparison.
 //---------------------------------------------------------------------------
 #include <iostream>
+#include <new>
 #include "bintree.h"
 using namespace std;
 
@@ -20,14 +21,29 @@ using namespace std;
 BinTree::BinTree()
 {
   this->root = nullptr;
+  this->arena = nullptr;
 } //end of BinTree
 
+//-----------------------------BinTree(arena)--------------------------------
+//Description: Constructor - the BST allocates its Nodes, and the NodeData
+//             it makes itself (emplace, copies), from the given arena. The
+//             arena must outlive the BST. NodeData given to insert or
+//             arrayToBSTree still come from new, as for any BinTree.
+//---------------------------------------------------------------------------
+BinTree::BinTree(NodeArena* arena)
+{
+  this->root = nullptr;
+  this->arena = arena;
+} //end of BinTree(arena)
+
 //------------------------------BinTree(bin)---------------------------------
-//Description: Copy constructor - calls copyTree helper to copy the BST.
+//Description: Copy constructor - calls copyTree helper to copy the BST. The
+//             copy allocates from the same arena as the original, if any.
 //---------------------------------------------------------------------------
 BinTree::BinTree(BinTree &bin)
 {
   this->root = nullptr;
+  this->arena = bin.arena;
   copyTree(this->root, bin.root);
 } //end of BinTree(bin)
 
@@ -49,77 +65,50 @@ BinTree::~BinTree()
 //---------------------------------------------------------------------------
 bool BinTree::retrieve(const NodeData &target, NodeData* &location) const
 {
-  if (isEmpty()) //If the BST is empty, return false.
-  {
-    return false;
-  }
   Node* nodeLocation; //Node for the node location of the target NodeData
-  bool found = findData(root, target, location, nodeLocation); //Otherwise, call
-  if (!found)                                                  //call the helper
-  {                                                            //function to find
-    return false;
-  }
-  return true;
+  return findData(this->root, target, location, nodeLocation);
 } //end of retrieve
 
-//--------------------------------findData-----------------------------------
-//Description: Recursive elper function to locate specified NodeData and identify
-//             the Node it's at. Returns true if found, false if not.
+//--------------------------------contains-----------------------------------
+//Description: Determines if the target value is in the BST. Returns true if
+//             yes, false if no.
 //---------------------------------------------------------------------------
-bool BinTree::findData(Node* root, const NodeData target, NodeData* &location, Node* &nodeLocation) const
+bool BinTree::contains(const NodeData &target) const
 {
-  if (root == nullptr) //Base case: If the node is empty, it's not in BST
-  {
-    return false;
-  }
-  else if (target == *root->data) //If target is found, set the node location,
-  {                               //and the NodeData value, and return true
-    location = root->data;
-    nodeLocation = root;
-    return true;
-  }
-  else if (target < *root->data) //If the node's value is larger than the target
-  {                              //then go left
-    return findData(root->left, target, location, nodeLocation);
-  }
-  else //Otherwise, go right
-  {
-    return findData(root->right, target, location, nodeLocation);
-  }
-} //end of findData
+  NodeData* location;
+  return retrieve(target, location);
+} //end of contains
+
+//-------------------------------compareKey----------------------------------
+//Description: Orders a NodeData against a raw key through NodeData::compare,
+//             so the lookup never constructs a NodeData.
+//---------------------------------------------------------------------------
+int BinTree::compareKey(const NodeData &data, string_view key)
+{
+  return data.compare(key);
+} //end of compareKey
 
 //-------------------------------getHeight-----------------------------------
 //Description: Public function to find the height of the specified NodeData.
-//             Calls findHeight helper function for calculation.
+//             Returns 0 if it isn't in the BST. Calls heightOf helper.
 //---------------------------------------------------------------------------
 int BinTree::getHeight(const NodeData &target) const
 {
-  if (isEmpty()) //If the BST is empty, per definition, the height is 0
-  {
-    return 0;
-  }
-  NodeData *location;
-  if (!retrieve(target, location)) //If the NodeData isn't found, return 0
-  {
-    return 0;
-  }
-  Node* nodeLocation;
-  findData(this->root, target, location, nodeLocation);
-  return findHeight(nodeLocation, target);
+  return heightOf(target);
 } //end of getHeight
 
 //-------------------------------findHeight----------------------------------
 //Description: Recursive helper function to calculate the height of the
 //             specified node.
 //---------------------------------------------------------------------------
-int BinTree::findHeight(Node* root, const NodeData &target) const
+int BinTree::findHeight(Node* root) const
 {
   if (root == nullptr) //Base Case: If reached an empty node, return 0
   {
     return 0;
   }
-  int leftSide = findHeight(root->left, target);
-  int rightSide = findHeight(root->right, target);
+  int leftSide = findHeight(root->left);
+  int rightSide = findHeight(root->right);
   if (leftSide > rightSide) //Determine which side is "taller", then return height
   {
     return leftSide + 1; //Add the 1 for the starting node, and return the value
@@ -140,63 +129,109 @@ bool BinTree::isEmpty() const
 
 //--------------------------------insert-------------------------------------
 //Description: Inserts NodeData object into the BST in the correct location
-//             if it does not already exist. Does so by iterations instead
-//             of recursion.
+//             if it does not already exist. The NodeData must come from new;
+//             the BST owns it once inserted. Calls findLink helper, so a Node
+//             is only allocated once the spot is found.
 //---------------------------------------------------------------------------
 bool BinTree::insert(NodeData* data)
 {
-  Node* newNode = new Node; //Allocate memory for the new node to be inserted
-  newNode->data = data;     //and assign it the NodeData being passed in
-  newNode->left = nullptr;
-  newNode->right = nullptr; //Initialize left and right pointers to nullptr
-  if (isEmpty())
+  Node** link = findLink(*data);
+  if (link == nullptr) //If the NodeData is in the BST, do not insert
+  {
+    return false;
+  }
+  *link = createNode(data, false);
+  return true; //If we've made it here, then the Node was inserted successfully
+} //end of insert
+
+//--------------------------------emplace------------------------------------
+//Description: Inserts a NodeData holding value if it does not already exist.
+//             The NodeData is made in the BST's arena if it has one, otherwise
+//             with new, and only once the spot is found. The string is built
+//             once and moved into the NodeData. Returns true if inserted.
+//---------------------------------------------------------------------------
+bool BinTree::emplace(string_view value)
+{
+  Node** link = findLink(value);
+  if (link == nullptr) //If the value is in the BST, do not insert
   {
-    this->root = newNode; //If the BST is empty, insert the node at the root
+    return false;
+  }
+  NodeData* data;
+  if (arena == nullptr)
+  {
+    data = new NodeData(string(value));
   }
   else
   {
-    Node* current = root;  //Create a node pointer to traverse from the root
-    bool inserted = false; //Flag indicating whether or not the node is inserted
-    while (!inserted) //Keep going through the BST until the node is inserted
-    {
-      if (*current->data == *data) //If the NodeData is in the BST, do not insert
-      {
-        delete newNode; //And delete the node created
-        newNode = nullptr;
-        return false;
-      }
-      else if (*current->data > *data) //If the NodeData is less than the current node
-      {
-        if (current->left == nullptr) //We've reached a leaf, and we can insert
-        {
-          current->left = newNode;
-          inserted = true;
-        }
-        else //Otherwise, we continue going left
-        {
-          current = current->left;
-        }
-      }
-      else //Otherwise, the NodeData is greater than the current node
-      {
-        if (current->right == nullptr) //We've reached a leaf, and we can insert
-        {
-          current->right = newNode;
-          inserted = true;
-        }
-        else //Otherwise, we continue going left
-        {
-          current = current->right;
-        }
-      }
-    }
+    data = new (arena->allocate(sizeof(NodeData))) NodeData(string(value));
   }
-  return true; //If we've made it here, then the Node was inserted successfully
-} //end of insert
+  *link = createNode(data, arena != nullptr);
+  return true;
+} //end of emplace
+
+//--------------------------------copyData-----------------------------------
+//Description: Helper function that allocates a copy of a NodeData, in the
+//             BST's arena if it has one, otherwise with new.
+//---------------------------------------------------------------------------
+NodeData* BinTree::copyData(const NodeData &value)
+{
+  if (arena == nullptr)
+  {
+    return new NodeData(value);
+  }
+  return new (arena->allocate(sizeof(NodeData))) NodeData(value);
+} //end of copyData
+
+//-------------------------------releaseData---------------------------------
+//Description: Helper function that releases a Node's NodeData the way it was
+//             allocated. Arena NodeData are only destroyed; their memory
+//             returns on the arena's reset.
+//---------------------------------------------------------------------------
+void BinTree::releaseData(Node* node)
+{
+  if (!node->arenaData)
+  {
+    delete node->data;
+  }
+  else if (node->data != nullptr)
+  {
+    node->data->~NodeData();
+  }
+  node->data = nullptr;
+} //end of releaseData
+
+//-------------------------------createNode----------------------------------
+//Description: Helper function that allocates a leaf Node holding data, from
+//             the BST's arena if it has one, otherwise with new. arenaData
+//             records whether data itself lives in the arena.
+//---------------------------------------------------------------------------
+BinTree::Node* BinTree::createNode(NodeData* data, bool arenaData)
+{
+  Node* node = (arena == nullptr) ? new Node : new (arena->allocate(sizeof(Node))) Node;
+  node->data = data;
+  node->left = nullptr;
+  node->right = nullptr;
+  node->arenaData = arenaData;
+  return node;
+} //end of createNode
+
+//-------------------------------destroyNode---------------------------------
+//Description: Helper function that releases a Node made by createNode.
+//---------------------------------------------------------------------------
+void BinTree::destroyNode(Node* node)
+{
+  if (arena == nullptr)
+  {
+    delete node;
+  }
+} //end of destroyNode
 
 //-----------------------------bstreeToArray---------------------------------
 //Description: Public function for converting the BST into an array, preserving
 //             the in-order ordering of the BST. Calls the treeToArray helper.
+//             Every NodeData placed in the array comes from new; NodeData
+//             in the BST's arena are copied out.
 //---------------------------------------------------------------------------
 void BinTree::bstreeToArray(NodeData* array[])
 {
@@ -207,34 +242,49 @@ void BinTree::bstreeToArray(NodeData* array[])
 
 //-------------------------------treeToArray---------------------------------
 //Description: Recursive helper function for converting the BST into an array,
-//             preserving the in-order ordering of the BST.
+//             preserving the in-order ordering of the BST. Returns the number
+//             of elements placed in the array so far.
 //---------------------------------------------------------------------------
 int BinTree::treeToArray(Node* root, NodeData* array[], int& index)
 {
   if (root == nullptr) //Base case: If the node is empty, go back
   {
-    return 0;
+    return index;
   }
   else //Otherwise, recursively insert the node into the next index in the array
   {    //using in-order traversal
     treeToArray(root->left, array, index); //In-order; go down left side first
-    array[index] = root->data; //Assign node value to the current index in array
+    if (root->arenaData) //Arena NodeData never leave the BST, so hand out a
+    {                    //copy from new instead
+      array[index] = new NodeData(*root->data);
+      releaseData(root);
+    }
+    else //Assign node value to the current index in array
+    {
+      array[index] = root->data;
+    }
     root->data = nullptr; //Cut the data in the node to avoid duplications
     index++; //Increment the index
     treeToArray(root->right, array, index); //Lastly, go down the right side
   }
+  return index;
 } //end of treeToArray
 
 //-----------------------------arrayToBSTree---------------------------------
 //Description: Public function to convert an incoming array into a balanced
-//             BST. Calls helper arrayToTree.
+//             BST. Any NodeData already in the BST is deleted first, so the
+//             result holds only the array's NodeData, which must come from
+//             new. Ownership of each NodeData moves to the BST and the array
+//             is left all nullptr.
+//             Calls helper arrayToTree.
 //---------------------------------------------------------------------------
 void BinTree::arrayToBSTree(NodeData* array[])
 {
+  emptyTree(this->root); //Start from an empty BST so each node lands in place
   int high, low; //Estblish variables for the indexes of the array
   high = low = 0;
-  for (int i = 0; i < 100; i++) //Determine largest index in the array by looping
-  {                             //over maximum size. Assumption: MAX_SIZE = 100;
+  for (int i = 0; i < ARRAYSIZE; i++) //Determine largest index in the array by
+  {                                   //looping over maximum size
     if (array[i] != nullptr)
     {
       high++;
@@ -245,19 +295,20 @@ void BinTree::arrayToBSTree(NodeData* array[])
 
 //-------------------------------arrayToTree---------------------------------
 //Description: Recursive helper function to convert given array of NodeData
-//             into a BST.
+//             into a BST. Ownership of each NodeData moves to the BST, so its
+//             slot in the array is set to nullptr.
 //---------------------------------------------------------------------------
 void BinTree::arrayToTree(Node* &root, NodeData* array[], int low, int high)
 {
   if (high < low) //Base Case: If high is less than low, the function has gone
   {               //through entire array, or incorrect value for indexes
-    root == nullptr;
+    return;
   }
   else
   {
     int rootIndex = (low + high) / 2;    //Formula for the index of the array that
-    NodeData* newData = array[rootIndex];//will be the root for the BST
-    insert(newData); //Estblish new node with data of the array, then pass to insert
+    root = createNode(array[rootIndex], false); //will be the root for the BST
+    array[rootIndex] = nullptr; //Cut the data in the array to avoid duplications
     arrayToTree(root->left, array, low, rootIndex - 1); //In-order: go left in BST
     arrayToTree(root->right, array, rootIndex + 1, high);//then right, going through
   }                                                     //elements in array
@@ -287,20 +338,20 @@ void BinTree::emptyTree(Node* &root)
   {    //deleted before the parent nodes
     emptyTree(root->left); //Post-order: traverse left, then right, then the node
     emptyTree(root->right);
-    delete root->data; //Delete data first, then the node
-    root->data = nullptr; //Assign each to a nullptr once deleted
-    delete root;
+    releaseData(root); //Delete data first (assigning it nullptr), then the node
+    destroyNode(root);
     root = nullptr;
   }
 } //end of emptyTree
 
 //-------------------------------operator=-----------------------------------
 //Description: Operator overload for assignment. Sets the current BinTree
-//             to the incoming BinTree. Calls the helper copyTree.
+//             to the incoming BinTree, keeping its own arena (if any) for
+//             the copy. Calls the helper copyTree.
 //---------------------------------------------------------------------------
 BinTree& BinTree::operator=(const BinTree &bin)
 {
-  if (*this == bin) //If the BSTs are the same, return the same BST
+  if (this == &bin) //If assigning to itself, return the same BST
   {
     return *this;
   }
@@ -324,9 +375,8 @@ void BinTree::copyTree(Node* &newRoot, Node* oldRoot)
   }
   else //Otherwise, deep copy the node and its data by creating a new Node and
   {    //NodeData
-    newRoot = new Node; //Allocate memory for new Node, and set the data
-    NodeData *newData = new NodeData(*oldRoot->data); //Allocate memory for NodeData
-    newRoot->data = newData; //Set the new Node's data value to the copying NodeData
+    NodeData *newData = copyData(*oldRoot->data); //Allocate memory for NodeData,
+    newRoot = createNode(newData, arena != nullptr); //then for the new Node
     copyTree(newRoot->left, oldRoot->left); //In-Order: traverse left, then right
     copyTree(newRoot->right, oldRoot->right);
   }
@@ -365,14 +415,14 @@ bool BinTree::operator!=(const BinTree &bin) const
 //---------------------------------------------------------------------------
 bool BinTree::findEquality(Node* root, Node* otherRoot) const
 {
-  if ((root != nullptr && otherRoot != nullptr) && (*root->data == *otherRoot->data))
-  { //Base case 1: If the node is not empty and the NodeData is the same, they are the same
+  if ((root == nullptr) && (otherRoot == nullptr))
+  { //Base case 1: If both of them are empty, they are the same
     return true;
   }
   if ((root == nullptr) || (otherRoot == nullptr))
-  { //Base case 2: If either of them are empty, they are different
+  { //Base case 2: If only one of them is empty, they are different
     return false;
-  } //Return true if the last leaf's NodeData matches after recursive calls, false if not
+  } //Return true if this NodeData and both subtrees match, false if not
   return (*root->data == *otherRoot->data) && findEquality(root->left, otherRoot->left) && findEquality(root->right, otherRoot->right);
 } //end of findEquality
 
@@ -402,6 +452,37 @@ void BinTree::inOrderPrint(Node* root, ostream &print) const
   inOrderPrint(root->right, print); //Then go right
 } //end of inOrderPrint
 
+//--------------------------------toString-----------------------------------
+//Description: Returns the BST's NodeData in in-order order, separated by
+//             single spaces with none at either end. Builds the text
+//             directly, without a stream. Calls helper inOrderAppend.
+//---------------------------------------------------------------------------
+string BinTree::toString() const
+{
+  string text;
+  inOrderAppend(root, text);
+  return text;
+} //end of toString
+
+//------------------------------inOrderAppend--------------------------------
+//Description: Recursive helper function to append each value in the BST to
+//             text using in-order traversal.
+//---------------------------------------------------------------------------
+void BinTree::inOrderAppend(Node* root, string &text) const
+{
+  if (root == nullptr) //Base case: If node is empty, go back
+  {
+    return;
+  }
+  inOrderAppend(root->left, text); //In-order: Go left until out of leftward Nodes
+  if (!text.empty()) //Then append the Node, after a space if not the first
+  {
+    text += ' ';
+  }
+  text += root->data->getData();
+  inOrderAppend(root->right, text); //Then go right
+} //end of inOrderAppend
+
 //------------------------------displaySideways------------------------------
 //Description: Public function to display the BST as if viewing it from the
 //             side; hard coded displaying to standard output. Calls helper
@@ -8,33 +8,57 @@
 //         Node for each node in the Binary Tree.
 //---------------------------------------------------------------------------
 //Notes: Assumption: NodeData provides proper data checking and overloads
-//       appropriate operators for comparison.
+//       appropriate operators for comparison, and compare() against a raw
+//       string_view key so lookups need not construct a NodeData.
+//       A BinTree may be given a NodeArena to allocate its Nodes and
+//       NodeData from; without one it uses new and delete.
+//       Ownership: every NodeData passed into or out of a BinTree (insert,
+//       bstreeToArray, arrayToBSTree) is allocated with new, whatever
+//       allocator the BinTree uses. NodeData a BinTree makes in its arena
+//       (emplace, copies) never leave it.
 //---------------------------------------------------------------------------
 #ifndef BINTREE_H
 #define BINTREE_H
 #include <iostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include "nodearena.h"
 #include "nodedata.h"
 using namespace std;
 
 class BinTree
 {
 public:
+  //Capacity of the arrays used by bstreeToArray and arrayToBSTree
+  static const int ARRAYSIZE = 100;
+
   //Constructors
   BinTree();
+  explicit BinTree(NodeArena* arena);
   BinTree(BinTree &bin);
   ~BinTree();
 
   //Getters
   int getHeight(const NodeData &target) const;
+  template <typename Key>
+  int getHeight(const Key &key) const;
   bool retrieve(const NodeData &target, NodeData* &location) const;
+  template <typename Key>
+  bool retrieve(const Key &key, NodeData* &location) const;
+  bool contains(const NodeData &target) const;
+  template <typename Key>
+  bool contains(const Key &key) const;
   bool isEmpty() const;
+  string toString() const;
   void displaySideways() const;
 
   //Setters
-  bool insert(NodeData* data);
+  bool insert(NodeData* data);           //data from new; the BST owns it
+  bool emplace(string_view value);       //Makes the NodeData in the BST
   void makeEmpty();
-  void bstreeToArray(NodeData* array[]);
-  void arrayToBSTree(NodeData* array[]);
+  void bstreeToArray(NodeData* array[]); //Fills array with NodeData from new
+  void arrayToBSTree(NodeData* array[]); //Takes NodeData from new
 
   //Operator Overloads
   //Assignment
@@ -51,19 +75,168 @@ private:
     NodeData* data;
     Node* left;
     Node* right;
+    bool arenaData; //data lives in the arena rather than coming from new
   };
   Node* root;
+  NodeArena* arena; //Source of Nodes and NodeData; nullptr for new/delete
 
   //Private and Helper Functions
-  int findHeight(Node* root, const NodeData &target) const;
+  Node* createNode(NodeData* data, bool arenaData);
+  void destroyNode(Node* node);
+  NodeData* copyData(const NodeData &value);
+  void releaseData(Node* node);
+  template <typename Key>
+  Node** findLink(const Key &key);
+  int findHeight(Node* root) const;
   void inOrderPrint(Node* root, ostream &print) const;
+  void inOrderAppend(Node* root, string &text) const;
   void copyTree(Node*& newRoot, Node* oldRoot);
   void emptyTree(Node* &root);
   bool findEquality(Node* root, Node* otherRoot) const;
   int treeToArray(Node* root, NodeData* array[], int& index);
   void arrayToTree(Node* &root, NodeData* array[], int low, int high);
   void sideways(Node* root, int level) const;
-  bool findData(Node* root, const NodeData target, NodeData* &location, Node* &nodeLocation) const;
+  template <typename Key>
+  bool findData(Node* root, const Key &key, NodeData* &location, Node* &nodeLocation) const;
+  template <typename Key>
+  int heightOf(const Key &key) const;
+  template <typename Key>
+  static decltype(auto) lookupKey(const Key &key);
+  template <typename Key>
+  static int compareKey(const NodeData &data, const Key &key);
+  static int compareKey(const NodeData &data, string_view key);
 };
 
+//-------------------------------getHeight-----------------------------------
+//Description: Public function to find the height of the NodeData matching a
+//             raw key (a string, string_view, string literal, or any type
+//             NodeData can be compared with). Returns 0 if it isn't in the
+//             BST. Calls heightOf helper.
+//---------------------------------------------------------------------------
+template <typename Key>
+int BinTree::getHeight(const Key &key) const
+{
+  return heightOf(lookupKey(key));
+} //end of getHeight
+
+//--------------------------------retrieve-----------------------------------
+//Description: Searches for, and assigns if located, the NodeData matching a
+//             raw key, without constructing a NodeData for the lookup.
+//             Returns true if found, false if not. Calls findData helper.
+//---------------------------------------------------------------------------
+template <typename Key>
+bool BinTree::retrieve(const Key &key, NodeData* &location) const
+{
+  Node* nodeLocation; //Node for the node location of the matching NodeData
+  return findData(this->root, lookupKey(key), location, nodeLocation);
+} //end of retrieve
+
+//--------------------------------contains-----------------------------------
+//Description: Determines if the NodeData matching a raw key is in the BST.
+//             Returns true if yes, false if no.
+//---------------------------------------------------------------------------
+template <typename Key>
+bool BinTree::contains(const Key &key) const
+{
+  NodeData* location;
+  return retrieve(key, location);
+} //end of contains
+
+//--------------------------------lookupKey----------------------------------
+//Description: Helper function that passes string-like keys on as a
+//             string_view, so they are compared through NodeData::compare
+//             without allocating. Any other key is passed on unchanged.
+//---------------------------------------------------------------------------
+template <typename Key>
+decltype(auto) BinTree::lookupKey(const Key &key)
+{
+  if constexpr (is_convertible_v<const Key&, string_view>)
+  {
+    return string_view(key);
+  }
+  else
+  {
+    return key;
+  }
+} //end of lookupKey
+
+//-------------------------------compareKey----------------------------------
+//Description: Orders a NodeData against a lookup key using NodeData's
+//             operators. Returns 0 if they match, a positive value if the
+//             NodeData is larger, and a negative value if it is smaller.
+//---------------------------------------------------------------------------
+template <typename Key>
+int BinTree::compareKey(const NodeData &data, const Key &key)
+{
+  if (data == key)
+  {
+    return 0;
+  }
+  return (data > key) ? 1 : -1;
+} //end of compareKey
+
+//--------------------------------findData-----------------------------------
+//Description: Recursive helper function to locate the NodeData matching the
+//             key and identify the Node it's at. The key may be a NodeData or
+//             any type compareKey accepts. Returns true if found, false if not.
+//---------------------------------------------------------------------------
+template <typename Key>
+bool BinTree::findData(Node* root, const Key &key, NodeData* &location, Node* &nodeLocation) const
+{
+  if (root == nullptr) //Base case: If the node is empty, it's not in BST
+  {
+    return false;
+  }
+  int order = compareKey(*root->data, key);
+  if (order == 0) //If key is found, set the node location,
+  {               //and the NodeData value, and return true
+    location = root->data;
+    nodeLocation = root;
+    return true;
+  }
+  else if (order > 0) //If the node's value is larger than the key
+  {                   //then go left
+    return findData(root->left, key, location, nodeLocation);
+  }
+  else //Otherwise, go right
+  {
+    return findData(root->right, key, location, nodeLocation);
+  }
+} //end of findData
+
+//--------------------------------findLink-----------------------------------
+//Description: Helper function that walks from the root to where the key
+//             belongs, by iteration. Returns the empty link a new Node for
+//             the key should fill, or nullptr if the key is already in the BST.
+//---------------------------------------------------------------------------
+template <typename Key>
+BinTree::Node** BinTree::findLink(const Key &key)
+{
+  Node** link = &this->root;
+  while (*link != nullptr) //Keep going until reaching an empty link
+  {
+    int order = compareKey(*(*link)->data, key);
+    if (order == 0) //The key is already in the BST
+    {
+      return nullptr;
+    }
+    link = (order > 0) ? &(*link)->left : &(*link)->right; //Left if the node
+  }                                                        //is larger
+  return link;
+} //end of findLink
+
+//--------------------------------heightOf-----------------------------------
+//Description: Helper function to find the height of the NodeData matching
+//             the key. Returns 0 if it isn't found (or the BST is empty).
+//             Calls findData, then findHeight.
+//---------------------------------------------------------------------------
+template <typename Key>
+int BinTree::heightOf(const Key &key) const
+{
+  NodeData* location;
+  Node* nodeLocation = nullptr;
+  findData(this->root, key, location, nodeLocation);
+  return findHeight(nodeLocation); //findHeight of an empty node is 0
+} //end of heightOf
+
 #endif
@@ -0,0 +1,147 @@
+//---------------------------bintree_alloc_test.cpp--------------------------
+//Purpose: Allocation-counting tests for BinTree. Replaces the global
+//         operator new with a counter and checks that raw-key lookups and
+//         rejected duplicate inserts make no heap allocation, and that
+//         emplace into an arena BST allocates once per new value.
+//---------------------------------------------------------------------------
+//Notes: Kept apart from bintree_test.cpp, because replacing operator new
+//       turns off ASan's new/delete mismatch checks for the whole binary.
+//---------------------------------------------------------------------------
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+#include "bintree.h"
+using namespace std;
+
+static int failures = 0;
+static long allocations = 0; //Calls to the global operator new
+
+//Count every heap allocation made through new
+void* operator new(size_t size)
+{
+  allocations++;
+  if (void* block = malloc(size > 0 ? size : 1))
+  {
+    return block;
+  }
+  throw bad_alloc();
+}
+
+void operator delete(void* block) noexcept
+{
+  free(block);
+}
+
+void operator delete(void* block, size_t) noexcept
+{
+  free(block);
+}
+
+#define CHECK(cond)                                                      \
+  do                                                                     \
+  {                                                                      \
+    if (!(cond))                                                         \
+    {                                                                    \
+      cerr << __FILE__ << ":" << __LINE__ << ": CHECK failed: " #cond << endl; \
+      failures++;                                                        \
+    }                                                                    \
+  } while (0)
+
+static void buildFrom(BinTree &tree, const vector<string> &keys)
+{
+  for (const string &key : keys)
+  {
+    tree.insert(new NodeData(key));
+  }
+}
+
+//Raw-key lookups construct no NodeData and copy nothing per level
+static void testKeyAllocations()
+{
+  BinTree tree;
+  vector<string> keys;
+  for (int i = 0; i < 64; i++) //Keys longer than the small-string buffer
+  {
+    keys.push_back("a-key-longer-than-the-small-string-buffer-" + to_string(i * 37 % 64));
+  }
+  long built = allocations;
+  buildFrom(tree, keys);
+  CHECK(allocations > built); //The counter sees the inserts
+  NodeData target(keys[5]);
+  string missing = keys[5] + "-missing";
+  long before = allocations;
+  NodeData* location;
+  int total = 0;
+  for (const string &key : keys)
+  {
+    total += tree.retrieve(key, location);
+    total += tree.retrieve(string_view(key), location);
+    total += tree.contains(key.c_str());
+    total += tree.getHeight(key) > 0;
+  }
+  total += tree.retrieve("a-key-longer-than-the-small-string-buffer-7", location);
+  total += !tree.contains(missing);
+  total += tree.retrieve(target, location) && tree.getHeight(target) > 0;
+  CHECK(allocations == before);
+  CHECK(total == 4 * 64 + 3);
+}
+
+//A rejected duplicate no longer allocates a Node
+static void testDuplicateInsert()
+{
+  BinTree tree;
+  buildFrom(tree, {"b", "a", "c"});
+  NodeData* ptr = new NodeData("a");
+  long before = allocations;
+  CHECK(!tree.insert(ptr));
+  CHECK(allocations == before);
+  delete ptr;
+}
+
+//emplace builds each value's string once and moves it into the NodeData
+static void testEmplaceAllocations()
+{
+  vector<string> keys;
+  for (int i = 0; i < 64; i++) //Keys longer than the small-string buffer
+  {
+    keys.push_back("a-key-longer-than-the-small-string-buffer-" + to_string(i * 37 % 64));
+  }
+  NodeArena arena;
+  {
+    BinTree warm(&arena); //Take the arena's blocks up front
+    for (const string &key : keys)
+    {
+      warm.emplace(key);
+    }
+  }
+  arena.reset();
+  BinTree tree(&arena);
+  BinTree plain;
+  long before = allocations;
+  for (const string &key : keys) //Only the string's buffer hits the heap
+  {
+    CHECK(tree.emplace(key));
+  }
+  CHECK(allocations - before == (long)keys.size());
+  before = allocations;
+  CHECK(!tree.emplace(keys[3]) && !tree.emplace(string_view(keys[9])));
+  CHECK(allocations == before); //Duplicates allocate nothing
+  before = allocations;
+  CHECK(plain.emplace(keys[0])); //Node, NodeData and the string's buffer
+  CHECK(allocations - before == 3);
+}
+
+int main()
+{
+  testKeyAllocations();
+  testDuplicateInsert();
+  testEmplaceAllocations();
+  if (failures > 0)
+  {
+    cerr << failures << " check(s) failed" << endl;
+    return 1;
+  }
+  cout << "bintree_alloc_test: all checks passed" << endl;
+  return 0;
+}
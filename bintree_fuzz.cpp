@@ -0,0 +1,110 @@
+//------------------------------bintree_fuzz.cpp-----------------------------
+//Purpose: libFuzzer entry point for BinTree. The input uses the buildTree
+//         token format from lab2: whitespace-separated strings, with each
+//         "$$" ending one tree. Every tree is checked against std::set.
+//---------------------------------------------------------------------------
+//Notes: Build with -fsanitize=fuzzer (BINTREE_FUZZ=ON, Clang only). With
+//       BINTREE_FUZZ_REPLAY defined, a main() runs each file argument
+//       through the entry point once, so the check also runs under GCC.
+//---------------------------------------------------------------------------
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "bintree.h"
+using namespace std;
+
+//-------------------------------checkTree-----------------------------------
+//Description: Aborts unless the BinTree built from one segment matches the
+//             std::set built from the same tokens.
+//---------------------------------------------------------------------------
+static void checkTree(BinTree &tree, const set<string> &contents)
+{
+  ostringstream print;
+  print << tree;
+  istringstream read(print.str());
+  vector<string> tokens((istream_iterator<string>(read)), istream_iterator<string>());
+  if (tokens != vector<string>(contents.begin(), contents.end()))
+  {
+    abort(); //In-order contents, ordering and size must match the model
+  }
+  for (const string &key : contents)
+  {
+    NodeData* location;
+    if (!tree.retrieve(NodeData(key), location) || tree.getHeight(NodeData(key)) < 1)
+    {
+      abort();
+    }
+  }
+  BinTree copy(tree);
+  BinTree assigned;
+  assigned = tree;
+  if (copy != tree || !(assigned == tree))
+  {
+    abort();
+  }
+  if (contents.size() <= BinTree::ARRAYSIZE) //bstreeToArray/arrayToBSTree round trip
+  {
+    NodeData* ndArray[BinTree::ARRAYSIZE] = {};
+    tree.bstreeToArray(ndArray);
+    tree.arrayToBSTree(ndArray);
+    ostringstream roundTrip;
+    roundTrip << tree;
+    if (roundTrip.str() != print.str())
+    {
+      abort();
+    }
+  }
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+  istringstream infile(string(reinterpret_cast<const char*>(data), size));
+  BinTree tree;
+  set<string> contents;
+  string s;
+  while (infile >> s) //Same tokens buildTree reads
+  {
+    if (s == "$$") //End of one tree
+    {
+      checkTree(tree, contents);
+      tree.makeEmpty();
+      contents.clear();
+      continue;
+    }
+    NodeData* ptr = new NodeData(s);
+    bool inserted = tree.insert(ptr);
+    if (!inserted)
+    {
+      delete ptr; //Duplicate case, not inserted
+    }
+    if (inserted != contents.insert(s).second)
+    {
+      abort();
+    }
+  }
+  checkTree(tree, contents); //Unterminated final tree
+  return 0;
+}
+
+#ifdef BINTREE_FUZZ_REPLAY
+int main(int argc, char* argv[])
+{
+  for (int i = 1; i < argc; i++)
+  {
+    ifstream infile(argv[i], ios::binary);
+    if (!infile)
+    {
+      cerr << "File could not be opened: " << argv[i] << endl;
+      return 1;
+    }
+    string input((istreambuf_iterator<char>(infile)), istreambuf_iterator<char>());
+    LLVMFuzzerTestOneInput(reinterpret_cast<const uint8_t*>(input.data()), input.size());
+  }
+  return 0;
+}
+#endif
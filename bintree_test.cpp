@@ -0,0 +1,450 @@
+//------------------------------bintree_test.cpp-----------------------------
+//Purpose: Randomized differential test for BinTree. Drives a BinTree and a
+//         reference model (std::set for contents, a plain BST for shape)
+//         with the same operation sequences and checks the BST invariant,
+//         size and heights after every step. Also holds regression cases
+//         for defects fixed in BinTree, and runs the same model with a
+//         NodeArena.
+//---------------------------------------------------------------------------
+//Notes: Built with -fsanitize=address,undefined by default (see
+//       CMakeLists.txt), so memory errors fail the run as well. Allocation
+//       counting lives in bintree_alloc_test.cpp, so this harness keeps
+//       ASan's own operator new and delete.
+//---------------------------------------------------------------------------
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "bintree.h"
+using namespace std;
+
+static int failures = 0;
+#define CHECK(cond)                                                      \
+  do                                                                     \
+  {                                                                      \
+    if (!(cond))                                                         \
+    {                                                                    \
+      cerr << __FILE__ << ":" << __LINE__ << ": CHECK failed: " #cond << endl; \
+      failures++;                                                        \
+    }                                                                    \
+  } while (0)
+
+//-------------------------------RefNode-------------------------------------
+//Description: Reference BST used to predict the shape, and so the heights,
+//             BinTree should have after each operation.
+//---------------------------------------------------------------------------
+struct RefNode
+{
+  string key;
+  unique_ptr<RefNode> left;
+  unique_ptr<RefNode> right;
+};
+
+static bool refInsert(unique_ptr<RefNode> &root, const string &key)
+{
+  if (root == nullptr)
+  {
+    root.reset(new RefNode{key, nullptr, nullptr});
+    return true;
+  }
+  if (key == root->key)
+  {
+    return false;
+  }
+  return refInsert(key < root->key ? root->left : root->right, key);
+}
+
+static unique_ptr<RefNode> refBalanced(const vector<string> &keys, int low, int high)
+{
+  if (high < low)
+  {
+    return nullptr;
+  }
+  int mid = (low + high) / 2; //Same split BinTree::arrayToTree uses
+  unique_ptr<RefNode> root(new RefNode{keys[mid], nullptr, nullptr});
+  root->left = refBalanced(keys, low, mid - 1);
+  root->right = refBalanced(keys, mid + 1, high);
+  return root;
+}
+
+static const RefNode* refFind(const RefNode* root, const string &key)
+{
+  while (root != nullptr && root->key != key)
+  {
+    root = key < root->key ? root->left.get() : root->right.get();
+  }
+  return root;
+}
+
+static int refHeight(const RefNode* root)
+{
+  if (root == nullptr)
+  {
+    return 0;
+  }
+  return 1 + max(refHeight(root->left.get()), refHeight(root->right.get()));
+}
+
+//-------------------------------inOrder-------------------------------------
+//Description: Returns the BinTree's contents as printed by operator<<.
+//---------------------------------------------------------------------------
+static vector<string> inOrder(const BinTree &tree)
+{
+  ostringstream print;
+  print << tree;
+  istringstream read(print.str());
+  vector<string> tokens;
+  string token;
+  while (read >> token)
+  {
+    tokens.push_back(token);
+  }
+  return tokens;
+}
+
+//-------------------------------checkModel----------------------------------
+//Description: Checks the BST invariant, size and every node's height of the
+//             BinTree against the reference model.
+//---------------------------------------------------------------------------
+static void checkModel(const BinTree &tree, const set<string> &contents, const RefNode* shape)
+{
+  vector<string> tokens = inOrder(tree);
+  for (size_t i = 1; i < tokens.size(); i++) //BST invariant: strictly ascending
+  {
+    CHECK(tokens[i - 1] < tokens[i]);
+  }
+  CHECK(tokens.size() == contents.size()); //Size
+  CHECK(tokens == vector<string>(contents.begin(), contents.end()));
+  CHECK(tree.isEmpty() == contents.empty());
+  string joined; //toString matches operator<< without its trailing space
+  for (const string &key : contents)
+  {
+    joined += (joined.empty() ? "" : " ") + key;
+  }
+  CHECK(tree.toString() == joined);
+  for (const string &key : contents) //Heights, and retrieve returns the node
+  {
+    NodeData* location = nullptr;
+    CHECK(tree.retrieve(NodeData(key), location));
+    CHECK(location != nullptr && *location == NodeData(key));
+    CHECK(tree.getHeight(NodeData(key)) == refHeight(refFind(shape, key)));
+    CHECK(tree.contains(NodeData(key)));
+    NodeData* byKey = nullptr; //Raw-key overloads find the same node
+    CHECK(tree.retrieve(key, byKey) && byKey == location);
+    byKey = nullptr;
+    CHECK(tree.retrieve(string_view(key), byKey) && byKey == location);
+    byKey = nullptr;
+    CHECK(tree.retrieve(key.c_str(), byKey) && byKey == location);
+    CHECK(tree.contains(key) && tree.contains(string_view(key)));
+    CHECK(tree.getHeight(key) == refHeight(refFind(shape, key)));
+    CHECK(tree.getHeight(key.c_str()) == tree.getHeight(NodeData(key)));
+  }
+  NodeData* location = nullptr;
+  CHECK(!tree.retrieve(NodeData("#absent"), location));
+  CHECK(tree.getHeight(NodeData("#absent")) == 0);
+  CHECK(!tree.retrieve("#absent", location) && !tree.contains(string("#absent")));
+  CHECK(!tree.contains(NodeData("#absent")) && tree.getHeight("#absent") == 0);
+}
+
+//---------------------------differentialTest--------------------------------
+//Description: Runs random operation sequences on BinTree and the model,
+//             with the BinTree allocating from a NodeArena if useArena.
+//---------------------------------------------------------------------------
+static void differentialTest(unsigned seed, int rounds, bool useArena)
+{
+  mt19937 rng(seed);
+  NodeArena arena(1024); //Small blocks so rounds span several
+  for (int round = 0; round < rounds; round++)
+  {
+    arena.reset(); //The previous round's trees are gone
+    BinTree tree(useArena ? &arena : nullptr);
+    set<string> contents;
+    unique_ptr<RefNode> shape;
+    int steps = rng() % 80;
+    for (int step = 0; step < steps; step++)
+    {
+      int op = rng() % 20;
+      if (op < 14) //insert
+      {
+        string key(1 + rng() % 3, 'a');
+        for (char &c : key)
+        {
+          c = 'a' + rng() % 5;
+        }
+        bool inserted;
+        if (rng() % 2 == 0) //NodeData from new, whatever the allocator
+        {
+          NodeData* ptr = new NodeData(key);
+          inserted = tree.insert(ptr);
+          if (!inserted)
+          {
+            delete ptr;
+          }
+        }
+        else //NodeData made by the BST itself
+        {
+          inserted = tree.emplace(key);
+        }
+        CHECK(inserted == contents.insert(key).second);
+        refInsert(shape, key);
+      }
+      else if (op < 16) //copy constructor and operator=
+      {
+        BinTree copy(tree);
+        CHECK(copy == tree);
+        BinTree assigned(useArena ? &arena : nullptr);
+        assigned.emplace("#other");
+        assigned = tree;
+        CHECK(assigned == tree);
+        CHECK(!(assigned != tree));
+        checkModel(copy, contents, shape.get());
+      }
+      else if (op < 18) //bstreeToArray, then arrayToBSTree
+      {
+        if (contents.size() <= BinTree::ARRAYSIZE)
+        {
+          NodeData* ndArray[BinTree::ARRAYSIZE] = {};
+          tree.bstreeToArray(ndArray);
+          CHECK(tree.isEmpty());
+          for (size_t i = 0; i < BinTree::ARRAYSIZE; i++)
+          {
+            CHECK((ndArray[i] != nullptr) == (i < contents.size()));
+          }
+          tree.arrayToBSTree(ndArray);
+          for (NodeData* slot : ndArray)
+          {
+            CHECK(slot == nullptr);
+          }
+          vector<string> keys(contents.begin(), contents.end());
+          shape = refBalanced(keys, 0, (int)keys.size() - 1);
+        }
+      }
+      else if (op < 19) //self-assignment
+      {
+        BinTree &self = tree;
+        tree = self;
+      }
+      else //makeEmpty
+      {
+        tree.makeEmpty();
+        contents.clear();
+        shape.reset();
+      }
+      checkModel(tree, contents, shape.get());
+    }
+  }
+}
+
+//------------------------------Regressions----------------------------------
+//Description: One case per defect fixed in BinTree.
+//---------------------------------------------------------------------------
+static void buildFrom(BinTree &tree, const vector<string> &keys)
+{
+  for (const string &key : keys)
+  {
+    tree.insert(new NodeData(key));
+  }
+}
+
+//treeToArray fell off the end of a non-void function (UBSan abort)
+static void testTreeToArray()
+{
+  BinTree tree;
+  buildFrom(tree, {"m", "c", "x", "a"});
+  NodeData* ndArray[BinTree::ARRAYSIZE] = {};
+  tree.bstreeToArray(ndArray);
+  CHECK(tree.isEmpty());
+  CHECK(*ndArray[0] == NodeData("a") && *ndArray[3] == NodeData("x"));
+  CHECK(ndArray[4] == nullptr);
+  for (int i = 0; i < 4; i++)
+  {
+    delete ndArray[i];
+  }
+}
+
+//findEquality compared the roots only
+static void testFindEquality()
+{
+  BinTree left, right, rootOnly;
+  buildFrom(left, {"b", "a"});
+  buildFrom(right, {"b", "c"});
+  buildFrom(rootOnly, {"b"});
+  CHECK(left != right);
+  CHECK(left != rootOnly);
+  CHECK(!(left == rootOnly));
+}
+
+//operator= skipped the copy when the roots matched
+static void testAssignment()
+{
+  BinTree tree, dup;
+  buildFrom(tree, {"b", "a"});
+  buildFrom(dup, {"b", "c"});
+  dup = tree;
+  NodeData* location;
+  CHECK(dup.retrieve(NodeData("a"), location));
+  CHECK(!dup.retrieve(NodeData("c"), location));
+  CHECK(dup == tree);
+  dup = dup;
+  CHECK(dup == tree);
+}
+
+//arrayToTree left each NodeData aliased in the array and the tree
+static void testArrayToTree()
+{
+  BinTree tree;
+  buildFrom(tree, {"a", "b", "c", "d", "e", "f", "g"});
+  NodeData* ndArray[BinTree::ARRAYSIZE] = {};
+  tree.bstreeToArray(ndArray);
+  tree.arrayToBSTree(ndArray);
+  for (NodeData* slot : ndArray)
+  {
+    CHECK(slot == nullptr); //Ownership moved to the BST
+  }
+  CHECK(tree.getHeight(NodeData("d")) == 3); //Balanced around the middle
+  CHECK(tree.getHeight(NodeData("b")) == 2);
+  CHECK(tree.getHeight(NodeData("g")) == 1);
+}
+
+//------------------------------Key lookups----------------------------------
+//Description: Raw-key overloads of retrieve, contains and getHeight.
+//---------------------------------------------------------------------------
+struct Word //Comparable with NodeData only by converting to it
+{
+  string text;
+  operator NodeData() const { return NodeData(text); }
+};
+
+static void testKeyOverloads()
+{
+  BinTree tree;
+  buildFrom(tree, {"m", "c", "x", "a"});
+  NodeData* location = nullptr;
+  CHECK(tree.retrieve("c", location) && *location == NodeData("c"));
+  CHECK(tree.retrieve(string("x"), location) && *location == NodeData("x"));
+  string_view view = "a";
+  CHECK(tree.retrieve(view, location) && *location == NodeData("a"));
+  location = nullptr;
+  CHECK(!tree.retrieve("b", location) && location == nullptr);
+  CHECK(tree.contains("m") && !tree.contains("mm") && !tree.contains(""));
+  CHECK(tree.getHeight("m") == 3 && tree.getHeight("c") == 2);
+  CHECK(tree.getHeight(string("a")) == 1 && tree.getHeight("q") == 0);
+  CHECK(tree.contains(Word{"x"}) && !tree.contains(Word{"y"}));
+  CHECK(tree.getHeight(Word{"c"}) == 2);
+
+  BinTree empty;
+  CHECK(!empty.retrieve("a", location) && !empty.contains(string("a")));
+  CHECK(empty.getHeight("a") == 0);
+}
+
+//--------------------------------Arenas-------------------------------------
+//Description: NodeArena itself, and BinTree's allocation through it.
+//---------------------------------------------------------------------------
+static void testNodeArena()
+{
+  NodeArena arena(256);
+  char* first = static_cast<char*>(arena.allocate(1));
+  char* second = static_cast<char*>(arena.allocate(24));
+  CHECK(second - first == (long)alignof(max_align_t)); //Aligned bump
+  CHECK(reinterpret_cast<uintptr_t>(second) % alignof(max_align_t) == 0);
+  char* big = static_cast<char*>(arena.allocate(4096)); //Oversized request
+  CHECK(big != nullptr && (big < first || big >= first + 256));
+  for (int i = 0; i < 100; i++) //Spills into further blocks
+  {
+    CHECK(arena.allocate(40) != nullptr);
+  }
+  arena.reset();
+  CHECK(arena.allocate(8) == first); //Blocks are reused after reset
+}
+
+static void testArenaTree()
+{
+  NodeArena arena;
+  BinTree plain;
+  {
+    BinTree tree(&arena);
+    for (const char* key : {"m", "c", "x", "a", "c", "a-key-longer-than-the-small-string-buffer"})
+    {
+      CHECK(tree.emplace(key) == plain.emplace(key)); //"c" twice: a duplicate
+    }
+    NodeData* ptr = new NodeData("b"); //NodeData from new in an arena BST
+    CHECK(tree.insert(ptr));
+    CHECK(plain.insert(new NodeData("b")));
+    CHECK(tree == plain && tree.getHeight("m") == 5);
+    BinTree copy(tree); //Shares the arena
+    CHECK(copy == tree);
+    BinTree assigned;   //Keeps new/delete
+    assigned = tree;
+    CHECK(assigned == plain);
+    NodeData* ndArray[BinTree::ARRAYSIZE] = {};
+    tree.bstreeToArray(ndArray);
+    tree.arrayToBSTree(ndArray);
+    CHECK(inOrder(tree) == inOrder(plain));
+  } //Trees release their NodeData before the arena is reset
+  arena.reset();
+}
+
+//Arrays carry NodeData from new between BSTs with different allocators.
+//Under ASan, freeing arena memory with delete, or leaking a NodeData from
+//new in an arena BST, fails the run.
+static void testCrossAllocatorArrays()
+{
+  NodeArena arena;
+  {
+    vector<string> keys = {"m", "c", "x", "a", "a-key-longer-than-the-small-string-buffer"};
+    BinTree fromArena(&arena);
+    BinTree plain;
+    for (const string &key : keys)
+    {
+      fromArena.emplace(key);
+    }
+    fromArena.insert(new NodeData("z")); //Mixed ownership inside one BST
+    string expected = inOrder(fromArena).back();
+
+    NodeData* ndArray[BinTree::ARRAYSIZE] = {};
+    fromArena.bstreeToArray(ndArray);   //Arena BST to plain BST
+    plain.arrayToBSTree(ndArray);
+    CHECK(fromArena.isEmpty() && plain.contains("a") && plain.contains("z"));
+    CHECK(inOrder(plain).size() == keys.size() + 1 && inOrder(plain).back() == expected);
+
+    BinTree toArena(&arena);
+    plain.bstreeToArray(ndArray);       //Plain BST to arena BST
+    toArena.arrayToBSTree(ndArray);
+    CHECK(plain.isEmpty() && toArena.contains("m"));
+    CHECK(inOrder(toArena).size() == keys.size() + 1);
+
+    BinTree copy(toArena);              //Copies made in the arena go back
+    copy.bstreeToArray(ndArray);        //out through new as well
+    plain.arrayToBSTree(ndArray);
+    CHECK(plain == toArena);
+
+    plain = toArena;                    //Assignment across allocators
+    toArena = plain;
+    CHECK(plain == toArena && toArena.getHeight("c") == plain.getHeight("c"));
+  }
+  arena.reset();
+}
+
+int main()
+{
+  testTreeToArray();
+  testFindEquality();
+  testAssignment();
+  testArrayToTree();
+  testKeyOverloads();
+  testNodeArena();
+  testArenaTree();
+  testCrossAllocatorArrays();
+  differentialTest(2019, 400, false);
+  differentialTest(2019, 400, true);
+  if (failures > 0)
+  {
+    cerr << failures << " check(s) failed" << endl;
+    return 1;
+  }
+  cout << "bintree_test: all checks passed" << endl;
+  return 0;
+}
@@ -0,0 +1,56 @@
+//------------------------------nodearena.cpp--------------------------------
+//Purpose: Implementation file for NodeArena, a bump allocator a BinTree can
+//         use for its Nodes and NodeData instead of new and delete.
+//---------------------------------------------------------------------------
+#include "nodearena.h"
+using namespace std;
+
+const size_t ALIGNMENT = alignof(max_align_t); //Suits any Node or NodeData
+
+//--------------------------------NodeArena----------------------------------
+//Description: Constructor - set the block size. No memory is taken until
+//             the first allocation.
+//---------------------------------------------------------------------------
+NodeArena::NodeArena(size_t blockSize)
+{
+  this->blockSize = (blockSize + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+  this->used = 0;
+  this->offset = this->blockSize; //Forces the first allocation to take a block
+} //end of NodeArena
+
+//--------------------------------allocate-----------------------------------
+//Description: Returns bytes of uninitialized memory, aligned for any object.
+//             Takes the next block when the current one is full.
+//---------------------------------------------------------------------------
+void* NodeArena::allocate(size_t bytes)
+{
+  bytes = (bytes + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+  if (bytes > blockSize) //Too big for a block, so give it its own
+  {
+    oversized.push_back(unique_ptr<char[]>(new char[bytes]));
+    return oversized.back().get();
+  }
+  if (offset + bytes > blockSize) //Current block is full; move to the next
+  {
+    if (used == blocks.size())
+    {
+      blocks.push_back(unique_ptr<char[]>(new char[blockSize]));
+    }
+    used++;
+    offset = 0;
+  }
+  void* memory = blocks[used - 1].get() + offset;
+  offset += bytes;
+  return memory;
+} //end of allocate
+
+//----------------------------------reset------------------------------------
+//Description: Makes all memory available again. Blocks are kept for reuse;
+//             oversized allocations are freed.
+//---------------------------------------------------------------------------
+void NodeArena::reset()
+{
+  oversized.clear();
+  used = 0;
+  offset = blockSize;
+} //end of reset
@@ -0,0 +1,39 @@
+//-------------------------------nodearena.h---------------------------------
+//Purpose: Header file for NodeArena, a bump allocator a BinTree can use for
+//         its Nodes and NodeData instead of new and delete.
+//---------------------------------------------------------------------------
+//Notes: Memory is handed out from large blocks and only given back by
+//       reset(), which keeps the blocks for reuse. Objects must be destroyed
+//       before reset(). A NodeArena is not thread safe; give each thread its
+//       own.
+//---------------------------------------------------------------------------
+#ifndef NODEARENA_H
+#define NODEARENA_H
+#include <cstddef>
+#include <memory>
+#include <vector>
+using namespace std;
+
+class NodeArena
+{
+public:
+  //Constructors
+  NodeArena(size_t blockSize = 64 * 1024);
+  NodeArena(const NodeArena &arena) = delete;
+  NodeArena& operator=(const NodeArena &arena) = delete;
+
+  //Setters
+  void* allocate(size_t bytes);
+  void reset();
+
+private:
+  vector<unique_ptr<char[]>> blocks;    //Blocks of blockSize bytes, kept
+                                        //across reset
+  vector<unique_ptr<char[]>> oversized; //Requests larger than blockSize,
+                                        //freed on reset
+  size_t blockSize;
+  size_t used;             //Number of blocks handed out from since reset
+  size_t offset;           //Next free byte in the current block
+};
+
+#endif
@@ -9,6 +9,8 @@ NodeData::NodeData(const NodeData& nd) { data = nd.data; }  // copy
 
 NodeData::NodeData(const string& s) { data = s; }    // cast string to NodeData
 
+NodeData::NodeData(string&& s) { data = move(s); }   // no copy of the string
+
 //------------------------- operator= ----------------------------------------
 NodeData& NodeData::operator=(const NodeData& rhs) {
 	if (this != &rhs) {
@@ -43,6 +45,13 @@ bool NodeData::operator>=(const NodeData& rhs) const {
 	return data >= rhs.data;
 }
 
+//------------------------------ compare -------------------------------------
+// compare against a raw key; returns <0, 0 or >0, as string::compare does
+
+int NodeData::compare(string_view key) const {
+	return string_view(data).compare(key);
+}
+
 //------------------------------ setData -------------------------------------
 // returns true if the data is set, false when bad data, i.e., is eof
 
@@ -51,6 +60,13 @@ bool NodeData::setData(istream& infile) {
 	return !infile.eof();       // eof function is true when eof char is read
 }
 
+//------------------------------ getData -------------------------------------
+// read-only access to the data, e.g. to build text without a stream
+
+const string& NodeData::getData() const {
+	return data;
+}
+
 //-------------------------- operator<< --------------------------------------
 ostream& operator<<(ostream& output, const NodeData& nd) {
 	output << nd.data;
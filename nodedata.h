@@ -1,6 +1,7 @@
 #ifndef NODEDATA_H
 #define NODEDATA_H
 #include <string>
+#include <string_view>
 #include <iostream>
 #include <fstream>
 using namespace std;
@@ -15,6 +16,7 @@ public:
 	NodeData();          // default constructor, data is set to an empty string
 	~NodeData();
 	NodeData(const string &);      // data is set equal to parameter
+	NodeData(string &&);           // data takes over parameter's contents
 	NodeData(const NodeData &);    // copy constructor
 	NodeData& operator=(const NodeData &);
 
@@ -22,6 +24,9 @@ public:
 	// returns true if the data is set, false when bad data, i.e., is eof
 	bool setData(istream&);
 
+	// read-only access to the data, e.g. to build text without a stream
+	const string& getData() const;
+
 	bool operator==(const NodeData &) const;
 	bool operator!=(const NodeData &) const;
 	bool operator<(const NodeData &) const;
@@ -29,6 +34,10 @@ public:
 	bool operator<=(const NodeData &) const;
 	bool operator>=(const NodeData &) const;
 
+	// compare against a raw key without constructing a NodeData
+	// returns <0, 0 or >0, as string::compare does
+	int compare(string_view) const;
+
 private:
 	string data;
 };
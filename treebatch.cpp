@@ -0,0 +1,219 @@
+//------------------------------treebatch.cpp--------------------------------
+//Purpose: Implementation file for TreeBatch, a workload engine that splits
+//         an input stream at "$$" boundaries, builds one BinTree per segment,
+//         and runs the lab2 query workload on each tree using a pool of
+//         threads.
+//---------------------------------------------------------------------------
+//Notes: Workers claim segments in small chunks from a shared atomic counter
+//       and write into a pre-sized result vector, so no locks are needed
+//       and results stay in input order.
+//---------------------------------------------------------------------------
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <iterator>
+#include <mutex>
+#include <thread>
+#include "treebatch.h"
+using namespace std;
+
+const size_t CHUNKSIZE = 64;                 //Segments claimed by a worker at a time
+const string_view WHITESPACE = " \t\r\n\v\f"; //Characters separating tokens
+
+//--------------------------------TreeBatch----------------------------------
+//Description: Constructor - set the query keys and number of worker threads.
+//             A thread count of 0 or less uses one per hardware thread.
+//             useArenas false makes every BinTree use new and delete.
+//---------------------------------------------------------------------------
+TreeBatch::TreeBatch(const vector<string> &keys, int threads, bool useArenas)
+{
+  this->keys = keys;
+  this->threads = threads;
+  this->useArenas = useArenas;
+} //end of TreeBatch
+
+//---------------------------------run(input)--------------------------------
+//Description: Reads the whole stream, then processes it as a string. Calls
+//             run(string_view).
+//---------------------------------------------------------------------------
+vector<TreeBatch::Result> TreeBatch::run(istream &input) const
+{
+  string buffer((istreambuf_iterator<char>(input)), istreambuf_iterator<char>());
+  return run(string_view(buffer));
+} //end of run(input)
+
+//-----------------------------------run-------------------------------------
+//Description: Splits the input into segments, then builds and queries one
+//             BinTree per segment on a pool of worker threads. Returns one
+//             Result per segment, in input order. If any segment throws, the
+//             remaining work is abandoned, every started thread is joined,
+//             and the first exception is rethrown on the calling thread.
+//---------------------------------------------------------------------------
+vector<TreeBatch::Result> TreeBatch::run(string_view input) const
+{
+  vector<string_view> segments = splitSegments(input);
+  vector<Result> results(segments.size());
+  if (segments.empty()) //Nothing to do, so don't start any threads
+  {
+    return results;
+  }
+
+  size_t workers = threads > 0 ? threads : thread::hardware_concurrency();
+  size_t chunks = (segments.size() + CHUNKSIZE - 1) / CHUNKSIZE;
+  workers = max<size_t>(1, min(workers, chunks)); //No more workers than chunks
+
+  atomic<size_t> next(0); //Index of the next unclaimed segment
+  exception_ptr error;    //First exception thrown by any worker
+  mutex errorLock;
+  auto fail = [&]() //Record the current exception and stop handing out work
+  {
+    lock_guard<mutex> lock(errorLock);
+    if (!error)
+    {
+      error = current_exception();
+    }
+    next.store(segments.size());
+  };
+  auto work = [&]()
+  {
+    try
+    {
+      NodeArena arena; //This worker's arena, reused for every segment
+      NodeArena* workerArena = useArenas ? &arena : nullptr;
+      for (;;)
+      {
+        size_t begin = next.fetch_add(CHUNKSIZE); //Claim the next chunk
+        if (begin >= segments.size())
+        {
+          return;
+        }
+        size_t end = min(begin + CHUNKSIZE, segments.size());
+        for (size_t i = begin; i < end; i++) //Each segment owns its own slot
+        {
+          results[i] = processSegment(segments[i], workerArena);
+          if (workerArena != nullptr) //The segment's trees are gone; reuse
+          {                           //their memory for the next one
+            workerArena->reset();
+          }
+        }
+      }
+    }
+    catch (...)
+    {
+      fail();
+    }
+  };
+
+  vector<thread> pool;
+  try
+  {
+    pool.reserve(workers - 1);
+    for (size_t i = 1; i < workers; i++) //The calling thread is the last worker
+    {
+      pool.emplace_back(work);
+    }
+  }
+  catch (...) //Could not start a thread; join the ones already running
+  {
+    fail();
+  }
+  work();
+  for (thread &t : pool)
+  {
+    t.join();
+  }
+  if (error)
+  {
+    rethrow_exception(error);
+  }
+  return results;
+} //end of run
+
+//--------------------------------nextToken----------------------------------
+//Description: Returns the next whitespace-delimited token at or after pos,
+//             and moves pos just past it. Returns an empty view when no
+//             tokens are left. The returned view points into the input.
+//---------------------------------------------------------------------------
+string_view TreeBatch::nextToken(string_view input, size_t &pos)
+{
+  size_t start = input.find_first_not_of(WHITESPACE, pos);
+  if (start == string_view::npos) //Only whitespace left
+  {
+    pos = input.size();
+    return string_view();
+  }
+  pos = min(input.find_first_of(WHITESPACE, start), input.size());
+  return input.substr(start, pos - start);
+} //end of nextToken
+
+//------------------------------splitSegments--------------------------------
+//Description: Splits the input at each whitespace-delimited "$$" token. Any
+//             tokens left after the last "$$" form a final segment. The
+//             returned views point into the input.
+//---------------------------------------------------------------------------
+vector<string_view> TreeBatch::splitSegments(string_view input)
+{
+  vector<string_view> segments;
+  size_t segmentStart = 0;
+  size_t pos = 0;
+  for (string_view token = nextToken(input, pos); !token.empty(); token = nextToken(input, pos))
+  {
+    if (token == "$$") //End of one segment
+    {
+      size_t tokenStart = token.data() - input.data();
+      segments.push_back(input.substr(segmentStart, tokenStart - segmentStart));
+      segmentStart = pos;
+    }
+  }
+  size_t restPos = segmentStart; //Unterminated final segment
+  if (!nextToken(input, restPos).empty())
+  {
+    segments.push_back(input.substr(segmentStart));
+  }
+  return segments;
+} //end of splitSegments
+
+//-----------------------------processSegment--------------------------------
+//Description: Builds a BinTree from the tokens of one segment, as buildTree
+//             does in lab2, then runs retrieve, getHeight, copy, equality and
+//             array round-trip queries on it. Every BinTree allocates from
+//             arena, or uses new and delete if it is nullptr.
+//---------------------------------------------------------------------------
+TreeBatch::Result TreeBatch::processSegment(string_view segment, NodeArena* arena) const
+{
+  Result result;
+  result.size = 0;
+  BinTree tree(arena);
+  size_t pos = 0;
+  for (string_view token = nextToken(segment, pos); !token.empty(); token = nextToken(segment, pos))
+  {
+    if (tree.emplace(token)) //Duplicates are skipped without allocating
+    {
+      result.size++;
+    }
+  }
+
+  result.inOrder = tree.toString(); //No stream, so no shared locale work
+
+  for (const string &key : keys) //Lookups by raw key, no NodeData needed
+  {
+    NodeData* location;
+    result.found.push_back(tree.retrieve(key, location));
+    result.heights.push_back(tree.getHeight(key));
+  }
+
+  BinTree copy(tree);
+  BinTree assigned(arena);
+  assigned = tree;
+  result.copyEqual = (copy == tree) && (assigned == tree) && !(copy != tree);
+
+  result.arrayRoundTrip = false;
+  if (result.size <= BinTree::ARRAYSIZE) //arrayToBSTree assumes a fixed capacity
+  {
+    NodeData* ndArray[BinTree::ARRAYSIZE] = {};
+    tree.bstreeToArray(ndArray);
+    tree.arrayToBSTree(ndArray);
+    result.arrayRoundTrip = (tree.toString() == result.inOrder);
+  }
+  return result;
+} //end of processSegment
@@ -0,0 +1,53 @@
+//-------------------------------treebatch.h---------------------------------
+//Purpose: Header file for TreeBatch, a workload engine that splits an input
+//         stream at "$$" boundaries, builds one BinTree per segment, and runs
+//         the lab2 query workload on each tree using a pool of threads.
+//---------------------------------------------------------------------------
+//Notes: Each segment's BinTree is built and queried entirely on one thread,
+//       so BinTree itself needs no locking. Each worker thread has its own
+//       NodeArena, reset after every segment. Results are returned in the
+//       order the segments appear in the input.
+//---------------------------------------------------------------------------
+#ifndef TREEBATCH_H
+#define TREEBATCH_H
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "bintree.h"
+using namespace std;
+
+class TreeBatch
+{
+public:
+  //Outcome of the query workload for one segment
+  struct Result
+  {
+    string inOrder;      //In-order contents of the BST, single spaces
+                         //between NodeData and none at either end
+    int size;            //Number of distinct NodeData inserted
+    vector<bool> found;  //retrieve result for each query key
+    vector<int> heights; //getHeight result for each query key
+    bool copyEqual;      //Copy constructor and operator= yield equal BSTs
+    bool arrayRoundTrip; //bstreeToArray/arrayToBSTree kept the contents;
+  };                     //false if size exceeds the array capacity
+
+  //Constructors
+  TreeBatch(const vector<string> &keys, int threads = 0, bool useArenas = true);
+
+  //Getters
+  vector<Result> run(istream &input) const;
+  vector<Result> run(string_view input) const;
+
+private:
+  vector<string> keys; //Query keys for retrieve and getHeight
+  int threads;         //Worker count; 0 means one per hardware thread
+  bool useArenas;      //Per-thread NodeArenas instead of new/delete
+
+  //Private and Helper Functions
+  static string_view nextToken(string_view input, size_t &pos);
+  static vector<string_view> splitSegments(string_view input);
+  Result processSegment(string_view segment, NodeArena* arena) const;
+};
+
+#endif
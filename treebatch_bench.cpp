@@ -0,0 +1,78 @@
+//----------------------------treebatch_bench.cpp----------------------------
+//Purpose: Throughput benchmark for TreeBatch. Generates segments in the lab2
+//         token format and reports segments per second at 1, 2, 4 and the
+//         hardware number of threads, with per-thread NodeArenas and with
+//         plain new and delete.
+//---------------------------------------------------------------------------
+//Notes: Usage: treebatch_bench [segments] [tokens per segment]
+//       Configure with -DBINTREE_SANITIZE=OFF -DCMAKE_BUILD_TYPE=Release
+//       for meaningful numbers.
+//---------------------------------------------------------------------------
+#include <chrono>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "treebatch.h"
+using namespace std;
+
+//Random input of segments with the lab2 token format
+static string makeInput(int segments, int tokens)
+{
+  mt19937 rng(2019);
+  string input;
+  for (int i = 0; i < segments; i++)
+  {
+    for (int t = 0; t < tokens; t++)
+    {
+      input += string(1 + rng() % 6, 'a' + rng() % 26);
+      input += ' ';
+    }
+    input += "$$\n";
+  }
+  return input;
+}
+
+//Runs the batch once and returns the elapsed seconds
+static double timeRun(const TreeBatch &batch, string_view input, size_t &segments)
+{
+  auto start = chrono::steady_clock::now();
+  segments = batch.run(input).size();
+  return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char* argv[])
+{
+  int segments = argc > 1 ? atoi(argv[1]) : 200000;
+  int tokens = argc > 2 ? atoi(argv[2]) : 40;
+  string input = makeInput(segments, tokens);
+  vector<string> keys = {"and", "not", "sss", "tttt", "ooo", "y"};
+
+  vector<int> threadCounts = {1, 2, 4};
+  int hardware = thread::hardware_concurrency();
+  if (hardware > 4)
+  {
+    threadCounts.push_back(hardware);
+  }
+  cout << segments << " segments x " << tokens << " tokens, "
+       << hardware << " hardware thread(s)" << endl;
+  for (bool useArenas : {false, true})
+  {
+    double base = 0;
+    for (int threads : threadCounts)
+    {
+      TreeBatch batch(keys, threads, useArenas);
+      size_t done;
+      timeRun(batch, input, done); //Warm up
+      double seconds = timeRun(batch, input, done);
+      if (threads == 1)
+      {
+        base = seconds;
+      }
+      cout << (useArenas ? "arena     " : "new/delete") << "  threads " << threads << ": "
+           << done / seconds << " segments/s, speedup " << base / seconds << "x" << endl;
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,242 @@
+//-----------------------------treebatch_test.cpp----------------------------
+//Purpose: Tests for TreeBatch. Checks segment splitting, input ordering
+//         across many chunks, and that results match both a plain
+//         single-threaded model and TreeBatch itself at other thread counts,
+//         with and without per-thread NodeArenas.
+//---------------------------------------------------------------------------
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "treebatch.h"
+using namespace std;
+
+static int failures = 0;
+
+#define CHECK(cond)                                                      \
+  do                                                                     \
+  {                                                                      \
+    if (!(cond))                                                         \
+    {                                                                    \
+      cerr << __FILE__ << ":" << __LINE__ << ": CHECK failed: " #cond << endl; \
+      failures++;                                                        \
+    }                                                                    \
+  } while (0)
+
+static const vector<string> KEYS = {"and", "not", "sss", "tttt", "ooo", "y"};
+
+static bool sameResult(const TreeBatch::Result &a, const TreeBatch::Result &b)
+{
+  return a.inOrder == b.inOrder && a.size == b.size && a.found == b.found &&
+         a.heights == b.heights && a.copyEqual == b.copyEqual &&
+         a.arrayRoundTrip == b.arrayRoundTrip;
+}
+
+static bool sameResults(const vector<TreeBatch::Result> &a, const vector<TreeBatch::Result> &b)
+{
+  if (a.size() != b.size())
+  {
+    return false;
+  }
+  for (size_t i = 0; i < a.size(); i++)
+  {
+    if (!sameResult(a[i], b[i]))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+//------------------------------modelRun-------------------------------------
+//Description: Single-threaded model of TreeBatch: reads tokens as buildTree
+//             does and queries each BinTree directly, one segment at a time.
+//---------------------------------------------------------------------------
+static vector<TreeBatch::Result> modelRun(const string &input, const vector<string> &keys)
+{
+  vector<TreeBatch::Result> results;
+  istringstream infile(input);
+  string s;
+  bool more = true;
+  while (more)
+  {
+    BinTree tree;
+    TreeBatch::Result result;
+    result.size = 0;
+    bool any = false;
+    more = false;
+    while (infile >> s)
+    {
+      if (s == "$$") //At end of one segment
+      {
+        more = true;
+        break;
+      }
+      any = true;
+      NodeData* ptr = new NodeData(s);
+      if (tree.insert(ptr))
+      {
+        result.size++;
+      }
+      else
+      {
+        delete ptr;
+      }
+    }
+    if (!more && !any) //Nothing after the last "$$"
+    {
+      break;
+    }
+    ostringstream print;
+    print << tree;
+    istringstream words(print.str());
+    string word;
+    while (words >> word)
+    {
+      result.inOrder += (result.inOrder.empty() ? "" : " ") + word;
+    }
+    for (const string &key : keys)
+    {
+      NodeData* location;
+      result.found.push_back(tree.retrieve(NodeData(key), location));
+      result.heights.push_back(tree.getHeight(NodeData(key)));
+    }
+    result.copyEqual = true;
+    result.arrayRoundTrip = result.size <= BinTree::ARRAYSIZE;
+    results.push_back(result);
+  }
+  return results;
+}
+
+//Random input of segments with the lab2 token format
+static string randomInput(unsigned seed, int segments)
+{
+  mt19937 rng(seed);
+  string input;
+  for (int i = 0; i < segments; i++)
+  {
+    int tokens = rng() % 40;
+    for (int t = 0; t < tokens; t++)
+    {
+      input += string(1 + rng() % 4, 'a' + rng() % 26);
+      input += (rng() % 8 == 0) ? "\r\n" : " ";
+    }
+    input += "$$\n";
+  }
+  return input;
+}
+
+static void testLab2Data()
+{
+  ifstream infile("data2.txt");
+  CHECK(infile);
+  vector<TreeBatch::Result> results = TreeBatch(KEYS, 2).run(infile);
+  CHECK(results.size() == 3);
+  if (results.size() == 3)
+  {
+    CHECK(results[0].inOrder == "and eee ff iii jj m not ooo pp r sssss tttt y z");
+    CHECK(results[0].size == 14);
+    CHECK((results[0].heights == vector<int>{1, 5, 0, 4, 1, 2})); //As lab2 prints
+    CHECK((results[0].found == vector<bool>{true, true, false, true, true, true}));
+    CHECK(results[1].inOrder == "a b c" && results[2].inOrder == "a b c");
+    for (const TreeBatch::Result &result : results)
+    {
+      CHECK(result.copyEqual && result.arrayRoundTrip);
+    }
+  }
+}
+
+static void testEmptySegments()
+{
+  vector<TreeBatch::Result> results = TreeBatch(KEYS, 4).run(string_view("$$ $$\n$$"));
+  CHECK(results.size() == 3);
+  for (const TreeBatch::Result &result : results)
+  {
+    CHECK(result.inOrder.empty() && result.size == 0);
+    CHECK(result.found == vector<bool>(KEYS.size(), false));
+    CHECK(result.heights == vector<int>(KEYS.size(), 0));
+    CHECK(result.copyEqual && result.arrayRoundTrip);
+  }
+  CHECK(TreeBatch(KEYS, 4).run(string_view("")).empty());
+  CHECK(TreeBatch(KEYS, 4).run(string_view(" \r\n\t ")).empty());
+}
+
+static void testSegmentBoundaries()
+{
+  TreeBatch batch(KEYS, 4);
+  vector<TreeBatch::Result> results = batch.run(string_view("b a $$ not and"));
+  CHECK(results.size() == 2); //Unterminated final segment is kept
+  if (results.size() == 2)
+  {
+    CHECK(results[0].inOrder == "a b");
+    CHECK(results[1].inOrder == "and not" && results[1].heights[0] == 1);
+  }
+  CHECK(batch.run(string_view("a $$ \r\n")).size() == 1); //Trailing whitespace only
+  results = batch.run(string_view("a$$ $$b $$"));         //"$$" must stand alone
+  CHECK(results.size() == 1 && results[0].inOrder == "$$b a$$");
+}
+
+static void testOrderAcrossChunks()
+{
+  string input;
+  const int segments = 1000; //Many more than one chunk per worker
+  for (int i = 0; i < segments; i++)
+  {
+    input += "k" + to_string(i) + " $$ ";
+  }
+  vector<TreeBatch::Result> results = TreeBatch(KEYS, 4).run(string_view(input));
+  CHECK(results.size() == segments);
+  for (int i = 0; i < (int)results.size(); i++)
+  {
+    CHECK(results[i].inOrder == "k" + to_string(i));
+  }
+}
+
+static void testMatchesModel()
+{
+  string input = randomInput(2019, 700) + "unterminated final tail";
+  vector<TreeBatch::Result> expected = modelRun(input, KEYS);
+  vector<TreeBatch::Result> single = TreeBatch(KEYS, 1).run(string_view(input));
+  CHECK(sameResults(single, expected));
+  for (int threads : {2, 3, 4, 8, 0}) //threads = 1 vs N give identical results
+  {
+    CHECK(sameResults(TreeBatch(KEYS, threads).run(string_view(input)), single));
+    CHECK(sameResults(TreeBatch(KEYS, threads, false).run(string_view(input)), single));
+  }
+  istringstream stream(input);
+  CHECK(sameResults(TreeBatch(KEYS, 4).run(stream), single));
+}
+
+static void testOverCapacity()
+{
+  string input;
+  for (int i = 0; i <= BinTree::ARRAYSIZE; i++)
+  {
+    input += "w" + to_string(i) + " ";
+  }
+  vector<TreeBatch::Result> results = TreeBatch(KEYS, 1).run(string_view(input));
+  CHECK(results.size() == 1);
+  if (results.size() == 1) //Too big for the array round trip, so it is skipped
+  {
+    CHECK(results[0].size == BinTree::ARRAYSIZE + 1);
+    CHECK(!results[0].arrayRoundTrip && results[0].copyEqual);
+  }
+}
+
+int main()
+{
+  testLab2Data();
+  testEmptySegments();
+  testSegmentBoundaries();
+  testOrderAcrossChunks();
+  testMatchesModel();
+  testOverCapacity();
+  if (failures > 0)
+  {
+    cerr << failures << " check(s) failed" << endl;
+    return 1;
+  }
+  cout << "treebatch_test: all checks passed" << endl;
+  return 0;
+}